@@ -12,16 +12,63 @@
 #include <string.h>
 #include <sys/stat.h>
 
-#define NUM_PROCESSES 3
-
-pid_t processos[NUM_PROCESSES];
+#define NUM_PROCESSES 3 // Processos de melhor esforço, escalonados por round-robin
+#define NUM_RT_TASKS 3 // Tarefas periódicas de tempo real, escalonadas por EDF
+#define NUM_TOTAL_PROCESSES (NUM_PROCESSES + NUM_RT_TASKS)
+#define RT_DENSIDADE_MAX 1.0 // Limite do teste de admissão (soma de C/D das tarefas admitidas)
+
+// Parâmetros de uma tarefa periódica, em ticks de IRQ0
+typedef struct {
+    int periodo;  // T: intervalo entre liberações de jobs
+    int wcet;     // C: pior tempo de execução de cada job
+    int deadline; // D: deadline relativo à liberação (C <= D <= T)
+} ParametrosRT;
+
+// Conjunto de tarefas de tempo real submetido ao teste de admissão na criação
+ParametrosRT parametros_rt[NUM_RT_TASKS] = {
+    {4, 1, 4},
+    {6, 2, 5},
+    {3, 2, 3}, // Excede a capacidade restante e deve ser rejeitada
+};
+
+typedef struct {
+    ParametrosRT p;
+    int admitida;
+    int proxima_liberacao; // Instante da próxima liberação de job
+    int liberacao;         // Instante de liberação do job corrente
+    int deadline_abs;      // Deadline absoluto do job corrente (chave do heap)
+    int restante;          // Ticks de execução que faltam ao job corrente
+    int job_pendente;
+    int deadline_perdido;  // Job corrente já ultrapassou o deadline
+    int pos_heap;          // Posição em heap_rt, ou -1 se não estiver pronta
+
+    // Métricas
+    int jobs_liberados;
+    int jobs_completos;
+    int jobs_descartados;  // Jobs ainda pendentes quando o próximo foi liberado
+    int deadlines_perdidos;
+    int atraso_max;        // Lateness = conclusão - deadline_abs (negativo se adiantado), só de jobs completos
+    long atraso_total;
+    int resposta_min;      // Tempo de resposta = conclusão - liberação
+    int resposta_max;      // Jitter = resposta_max - resposta_min
+} TarefaRT;
+
+pid_t processos[NUM_TOTAL_PROCESSES]; // Tarefa RT k ocupa o índice NUM_PROCESSES + k
 int current_process = 0;
-int processos_bloqueados[NUM_PROCESSES] = {0}; // Array para marcar processos bloqueados por I/O
-int processos_ativos[NUM_PROCESSES] = {1, 1, 1}; // Array para marcar processos ainda ativos
+int processos_bloqueados[NUM_TOTAL_PROCESSES] = {0}; // Array para marcar processos bloqueados por I/O
+int processos_ativos[NUM_TOTAL_PROCESSES] = {0}; // Array para marcar processos ainda ativos (marcados após o fork)
 int fila_io[NUM_PROCESSES]; // Fila para processos bloqueados em I/O
 int fila_io_inicio = 0;
 int fila_io_fim = 0;
 
+TarefaRT tarefas_rt[NUM_RT_TASKS];
+double densidade_rt = 0.0; // Soma de C/D das tarefas admitidas
+int heap_rt[NUM_RT_TASKS]; // Min-heap de tarefas prontas, ordenado por deadline absoluto
+int heap_rt_tamanho = 0;
+int tempo_atual = 0; // Ticks de IRQ0 desde a ativação
+int rt_em_execucao = -1; // Tarefa RT que está com a CPU, ou -1
+int melhor_esforco_preemptado = 0; // Processos de melhor esforço cederam a CPU ao EDF
+
 void enqueue_io(int index) {
     fila_io[fila_io_fim] = index;
     fila_io_fim = (fila_io_fim + 1) % NUM_PROCESSES;
@@ -37,8 +84,256 @@ int dequeue_io() {
     return index;
 }
 
+int heap_rt_menor(int a, int b) {
+    // Compara duas posições do heap; empates no deadline são resolvidos pelo índice da tarefa
+    int ta = heap_rt[a], tb = heap_rt[b];
+    if (tarefas_rt[ta].deadline_abs != tarefas_rt[tb].deadline_abs) {
+        return tarefas_rt[ta].deadline_abs < tarefas_rt[tb].deadline_abs;
+    }
+    return ta < tb;
+}
+
+void heap_rt_trocar(int a, int b) {
+    int tmp = heap_rt[a];
+    heap_rt[a] = heap_rt[b];
+    heap_rt[b] = tmp;
+    tarefas_rt[heap_rt[a]].pos_heap = a;
+    tarefas_rt[heap_rt[b]].pos_heap = b;
+}
+
+void heap_rt_subir(int pos) {
+    while (pos > 0 && heap_rt_menor(pos, (pos - 1) / 2)) {
+        heap_rt_trocar(pos, (pos - 1) / 2);
+        pos = (pos - 1) / 2;
+    }
+}
+
+void heap_rt_descer(int pos) {
+    while (1) {
+        int menor = pos;
+        int esq = 2 * pos + 1;
+        int dir = 2 * pos + 2;
+        if (esq < heap_rt_tamanho && heap_rt_menor(esq, menor)) menor = esq;
+        if (dir < heap_rt_tamanho && heap_rt_menor(dir, menor)) menor = dir;
+        if (menor == pos) break;
+        heap_rt_trocar(pos, menor);
+        pos = menor;
+    }
+}
+
+void heap_rt_inserir(int k) {
+    heap_rt[heap_rt_tamanho] = k;
+    tarefas_rt[k].pos_heap = heap_rt_tamanho;
+    heap_rt_tamanho++;
+    heap_rt_subir(tarefas_rt[k].pos_heap);
+}
+
+void heap_rt_remover(int k) {
+    int pos = tarefas_rt[k].pos_heap;
+    if (pos == -1) {
+        return;
+    }
+    heap_rt_tamanho--;
+    if (pos != heap_rt_tamanho) {
+        // Move o último elemento para a posição liberada e restaura a ordem do heap
+        heap_rt[pos] = heap_rt[heap_rt_tamanho];
+        tarefas_rt[heap_rt[pos]].pos_heap = pos;
+        heap_rt_subir(pos);
+        heap_rt_descer(tarefas_rt[heap_rt[pos]].pos_heap);
+    }
+    tarefas_rt[k].pos_heap = -1;
+}
+
+int heap_rt_topo() {
+    return heap_rt_tamanho > 0 ? heap_rt[0] : -1;
+}
+
+int admitir_tarefa_rt(int k) {
+    // Teste de admissão por densidade: o EDF cumpre todos os deadlines se a soma de C/D não passar de 1
+    ParametrosRT *p = &parametros_rt[k];
+    TarefaRT *t = &tarefas_rt[k];
+    memset(t, 0, sizeof(*t));
+    t->p = *p;
+    t->pos_heap = -1; // Também vale para tarefas rejeitadas, que nunca entram no heap
+    if (p->wcet <= 0 || p->wcet > p->deadline || p->deadline > p->periodo) {
+        printf("KernelSim: Tarefa RT %d rejeitada: parâmetros inválidos (T=%d, C=%d, D=%d).\n",
+               k, p->periodo, p->wcet, p->deadline);
+        fflush(stdout);
+        return 0;
+    }
+
+    double densidade = (double)p->wcet / p->deadline;
+    if (densidade_rt + densidade > RT_DENSIDADE_MAX) {
+        printf("KernelSim: Tarefa RT %d rejeitada: densidade %.3f + %.3f excede %.3f.\n",
+               k, densidade_rt, densidade, RT_DENSIDADE_MAX);
+        fflush(stdout);
+        return 0;
+    }
+
+    densidade_rt += densidade;
+    t->admitida = 1;
+    printf("KernelSim: Tarefa RT %d admitida (T=%d, C=%d, D=%d). Densidade RT: %.3f.\n",
+           k, p->periodo, p->wcet, p->deadline, densidade_rt);
+    fflush(stdout);
+    return 1;
+}
+
+void contabilizar_execucao_rt() {
+    // Desconta o tick que acabou de passar do job RT que estava com a CPU
+    if (rt_em_execucao == -1) {
+        return;
+    }
+    TarefaRT *t = &tarefas_rt[rt_em_execucao];
+    if (!t->job_pendente || --t->restante > 0) {
+        return;
+    }
+
+    int resposta = tempo_atual - t->liberacao;
+    int atraso = tempo_atual - t->deadline_abs;
+    if (t->jobs_completos == 0 || atraso > t->atraso_max) t->atraso_max = atraso;
+    if (t->jobs_completos == 0 || resposta < t->resposta_min) t->resposta_min = resposta;
+    if (t->jobs_completos == 0 || resposta > t->resposta_max) t->resposta_max = resposta;
+    t->atraso_total += atraso;
+    t->jobs_completos++;
+    t->job_pendente = 0;
+    heap_rt_remover(rt_em_execucao);
+
+    // A tarefa continua com a CPU até o despacho decidir quem executa em seguida
+    printf("KernelSim: Tarefa RT %d concluiu job em t=%d (resposta %d, atraso %d).\n",
+           rt_em_execucao, tempo_atual, resposta, atraso);
+    fflush(stdout);
+}
+
+void verificar_deadlines_rt() {
+    for (int k = 0; k < NUM_RT_TASKS; k++) {
+        TarefaRT *t = &tarefas_rt[k];
+        if (t->job_pendente && !t->deadline_perdido && tempo_atual >= t->deadline_abs) {
+            t->deadline_perdido = 1;
+            t->deadlines_perdidos++;
+            printf("KernelSim: Tarefa RT %d perdeu o deadline %d (faltam %d ticks).\n",
+                   k, t->deadline_abs, t->restante);
+            fflush(stdout);
+        }
+    }
+}
+
+void liberar_jobs_rt() {
+    for (int k = 0; k < NUM_RT_TASKS; k++) {
+        TarefaRT *t = &tarefas_rt[k];
+        if (!t->admitida || !processos_ativos[NUM_PROCESSES + k] || tempo_atual < t->proxima_liberacao) {
+            continue;
+        }
+
+        if (t->job_pendente) {
+            // O job anterior não terminou a tempo: é descartado em favor do novo
+            t->jobs_descartados++;
+            heap_rt_remover(k);
+            printf("KernelSim: Tarefa RT %d descartou job pendente liberado em t=%d.\n", k, t->liberacao);
+            fflush(stdout);
+        }
+
+        t->liberacao = t->proxima_liberacao;
+        t->deadline_abs = t->liberacao + t->p.deadline;
+        t->restante = t->p.wcet;
+        t->job_pendente = 1;
+        t->deadline_perdido = 0;
+        t->jobs_liberados++;
+        t->proxima_liberacao += t->p.periodo;
+        heap_rt_inserir(k);
+    }
+}
+
+void despachar_rt(int k) {
+    // Entrega a CPU à tarefa RT k, preemptando quem estiver executando
+    if (rt_em_execucao == k) {
+        return;
+    }
+
+    if (rt_em_execucao != -1) {
+        printf("KernelSim: Suspendendo tarefa RT %d (PID %d).\n",
+               rt_em_execucao, processos[NUM_PROCESSES + rt_em_execucao]);
+        fflush(stdout);
+        kill(processos[NUM_PROCESSES + rt_em_execucao], SIGUSR1);
+    } else if (!melhor_esforco_preemptado) {
+        melhor_esforco_preemptado = 1;
+        if (processos_ativos[current_process] && !processos_bloqueados[current_process]) {
+            printf("KernelSim: Preemptando processo %d para o EDF.\n", processos[current_process]);
+            fflush(stdout);
+            kill(processos[current_process], SIGUSR1);
+        }
+    }
+
+    rt_em_execucao = k;
+    printf("KernelSim: EDF ativando tarefa RT %d (PID %d, deadline %d) com SIGCONT.\n",
+           k, processos[NUM_PROCESSES + k], tarefas_rt[k].deadline_abs);
+    fflush(stdout);
+    kill(processos[NUM_PROCESSES + k], SIGCONT);
+}
+
+void retomar_melhor_esforco() {
+    // Devolve a capacidade restante aos processos de melhor esforço
+    melhor_esforco_preemptado = 0;
+    for (int i = 0; i < NUM_PROCESSES; i++) {
+        int candidato = (current_process + i) % NUM_PROCESSES;
+        if (processos_ativos[candidato] && !processos_bloqueados[candidato]) {
+            current_process = candidato;
+            printf("KernelSim: Ativando processo %d com SIGCONT.\n", processos[current_process]);
+            fflush(stdout);
+            kill(processos[current_process], SIGCONT);
+            return;
+        }
+    }
+    printf("KernelSim: Nenhum processo disponível para executar.\n");
+    fflush(stdout);
+}
+
+void imprimir_metricas_rt() {
+    printf("KernelSim: Métricas de tempo real após %d ticks:\n", tempo_atual);
+    for (int k = 0; k < NUM_RT_TASKS; k++) {
+        TarefaRT *t = &tarefas_rt[k];
+        if (!t->admitida) {
+            printf("  Tarefa RT %d: rejeitada na admissão.\n", k);
+            continue;
+        }
+        printf("  Tarefa RT %d (T=%d, C=%d, D=%d): %d jobs liberados, %d completos, %d deadlines perdidos, %d descartados, %d pendente",
+               k, t->p.periodo, t->p.wcet, t->p.deadline,
+               t->jobs_liberados, t->jobs_completos, t->deadlines_perdidos, t->jobs_descartados,
+               t->job_pendente);
+        if (t->jobs_completos > 0) {
+            // Jobs descartados não têm conclusão: ficam de fora de atraso e jitter
+            printf(", atraso máx %d, atraso médio %.2f, jitter %d (jobs completos)",
+                   t->atraso_max, (double)t->atraso_total / t->jobs_completos,
+                   t->resposta_max - t->resposta_min);
+        }
+        printf(".\n");
+    }
+    fflush(stdout);
+}
+
 void handle_irq0(int sig) {
     // Handler para simular a interrupção do time slice (IRQ0)
+    tempo_atual++;
+    contabilizar_execucao_rt();
+    verificar_deadlines_rt();
+    liberar_jobs_rt();
+
+    // Jobs de tempo real prontos têm prioridade; o de menor deadline absoluto executa
+    int proxima_rt = heap_rt_topo();
+    if (proxima_rt != -1) {
+        despachar_rt(proxima_rt);
+        return;
+    }
+    if (rt_em_execucao != -1) {
+        printf("KernelSim: Tarefa RT %d sem job pendente. Enviando SIGUSR1.\n", rt_em_execucao);
+        fflush(stdout);
+        kill(processos[NUM_PROCESSES + rt_em_execucao], SIGUSR1);
+        rt_em_execucao = -1;
+    }
+    if (melhor_esforco_preemptado) {
+        retomar_melhor_esforco();
+        return;
+    }
+
     if (processos_ativos[current_process] == 0 || processos_bloqueados[current_process]) {
         // Se o processo atual já terminou ou está bloqueado, não faz nada
         return;
@@ -114,6 +409,12 @@ void handle_syscall(int sig, siginfo_t *siginfo, void *context) {
     printf("KernelSim: Processo %d solicitou I/O, marcando como bloqueado.\n", pid);
     fflush(stdout);
 
+    if (rt_em_execucao != -1 || melhor_esforco_preemptado) {
+        // SIGUSR2 fica mascarado durante o IRQ0, então a syscall pode ser tratada depois que o
+        // despacho do EDF já parou o processo; ele fica bloqueado e ninguém é retomado aqui
+        return;
+    }
+
     // Enviar SIGUSR1 para o processo para que ele salve seu estado e pare
     kill(pid, SIGUSR1);
 
@@ -143,13 +444,25 @@ void handle_sigchld(int sig) {
     int status;
     pid_t pid;
     while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
-        for (int i = 0; i < NUM_PROCESSES; i++) {
+        for (int i = 0; i < NUM_TOTAL_PROCESSES; i++) {
             if (processos[i] == pid) {
                 processos_ativos[i] = 0;
                 processos_bloqueados[i] = 0; // Certifique-se de que o processo não esteja bloqueado
                 printf("KernelSim: Processo %d terminou. Marcando como inativo.\n", pid);
                 fflush(stdout);
 
+                if (i >= NUM_PROCESSES) {
+                    // Tarefa de tempo real: retirar do heap de deadlines
+                    int k = i - NUM_PROCESSES;
+                    heap_rt_remover(k);
+                    tarefas_rt[k].job_pendente = 0;
+                    densidade_rt -= (double)tarefas_rt[k].p.wcet / tarefas_rt[k].p.deadline; // Devolve a capacidade admitida
+                    if (rt_em_execucao == k) {
+                        rt_em_execucao = -1;
+                    }
+                    break;
+                }
+
                 // Atualizar o current_process se ele apontar para o processo terminado
                 if (current_process == i) {
                     // Encontrar o próximo processo ativo
@@ -188,12 +501,14 @@ void handle_sigchld(int sig) {
 }
 
 void handle_sigterm(int sig) {
-    printf("KernelSim: Recebido SIGTERM, encerrando...\n");
+    printf("KernelSim: Recebido %s, encerrando...\n", sig == SIGINT ? "SIGINT" : "SIGTERM");
     fflush(stdout);
+    imprimir_metricas_rt();
     // Encerra os processos filhos
-    for (int i = 0; i < NUM_PROCESSES; i++) {
+    for (int i = 0; i < NUM_TOTAL_PROCESSES; i++) {
         if (processos_ativos[i]) {
             kill(processos[i], SIGTERM);
+            kill(processos[i], SIGCONT); // Processos parados só tratam o SIGTERM depois de retomados
         }
     }
     // Remove o arquivo kernel_pid
@@ -218,10 +533,12 @@ int main() {
     printf("KernelSim: PID escrito no arquivo kernel_pid com sucesso.\n");
     fflush(stdout);
 
-    // Configurar os handlers para os sinais de time slice (SIGALRM), I/O completado (SIGUSR1), syscall de I/O (SIGUSR2), SIGCHLD, e SIGTERM
+    // Configurar os handlers para os sinais de time slice (SIGALRM), I/O completado (SIGUSR1), syscall de I/O (SIGUSR2), SIGCHLD, SIGTERM e SIGINT
     struct sigaction sa_irq0;
     sa_irq0.sa_handler = handle_irq0;
     sigemptyset(&sa_irq0.sa_mask);
+    sigaddset(&sa_irq0.sa_mask, SIGCHLD); // Não interromper o EDF no meio de uma operação do heap
+    sigaddset(&sa_irq0.sa_mask, SIGUSR2); // Nem no meio de uma troca de contexto
     sa_irq0.sa_flags = SA_RESTART;
     if (sigaction(SIGALRM, &sa_irq0, NULL) == -1) {
         perror("Erro ao configurar o handler para SIGALRM");
@@ -240,6 +557,7 @@ int main() {
     struct sigaction sa_syscall;
     sa_syscall.sa_sigaction = handle_syscall;
     sigemptyset(&sa_syscall.sa_mask);
+    sigaddset(&sa_syscall.sa_mask, SIGALRM);
     sa_syscall.sa_flags = SA_SIGINFO | SA_RESTART;
     if (sigaction(SIGUSR2, &sa_syscall, NULL) == -1) {
         perror("Erro ao configurar o handler para SIGUSR2");
@@ -249,6 +567,7 @@ int main() {
     struct sigaction sa_chld;
     sa_chld.sa_handler = handle_sigchld;
     sigemptyset(&sa_chld.sa_mask);
+    sigaddset(&sa_chld.sa_mask, SIGALRM);
     sa_chld.sa_flags = SA_RESTART;
     if (sigaction(SIGCHLD, &sa_chld, NULL) == -1) {
         perror("Erro ao configurar o handler para SIGCHLD");
@@ -258,24 +577,55 @@ int main() {
     struct sigaction sa_term;
     sa_term.sa_handler = handle_sigterm;
     sigemptyset(&sa_term.sa_mask);
+    // O mesmo handler atende SIGINT e SIGTERM e lê o estado do EDF: não pode ser reentrado nem interrompido
+    sigaddset(&sa_term.sa_mask, SIGINT);
+    sigaddset(&sa_term.sa_mask, SIGTERM);
+    sigaddset(&sa_term.sa_mask, SIGALRM);
+    sigaddset(&sa_term.sa_mask, SIGCHLD);
     sa_term.sa_flags = SA_RESTART;
     if (sigaction(SIGTERM, &sa_term, NULL) == -1) {
         perror("Erro ao configurar o handler para SIGTERM");
         exit(1);
     }
+    // Ctrl+C chega a todo o grupo de processos; tratar como SIGTERM para emitir as métricas de tempo real
+    if (sigaction(SIGINT, &sa_term, NULL) == -1) {
+        perror("Erro ao configurar o handler para SIGINT");
+        exit(1);
+    }
+
+    // Adiar sinais até o primeiro despacho: filhos parados antes do execv não podem tratar SIGINT/SIGTERM
+    // com os handlers do KernelSim, e um IRQ0 precoce não pode encontrar o EDF pela metade
+    sigset_t sinais_adiados;
+    sigemptyset(&sinais_adiados);
+    sigaddset(&sinais_adiados, SIGINT);
+    sigaddset(&sinais_adiados, SIGTERM);
+    sigaddset(&sinais_adiados, SIGALRM);
+    sigaddset(&sinais_adiados, SIGCHLD);
+    sigprocmask(SIG_BLOCK, &sinais_adiados, NULL);
+
+    // Criar os processos filhos (A1, A2, A3, etc...) e as tarefas de tempo real admitidas
+    for (int i = 0; i < NUM_TOTAL_PROCESSES; i++) {
+        int tempo_real = (i >= NUM_PROCESSES);
+        if (tempo_real && !admitir_tarefa_rt(i - NUM_PROCESSES)) {
+            continue;
+        }
 
-    // Criar os processos filhos (A1, A2, A3, etc...)
-    for (int i = 0; i < NUM_PROCESSES; i++) {
         pid_t pid = fork();
         if (pid == 0) {
             // Código do processo filho
-            char *args[] = {"./process", NULL};
+            signal(SIGINT, SIG_DFL);
+            signal(SIGTERM, SIG_DFL);
+            sigprocmask(SIG_UNBLOCK, &sinais_adiados, NULL);
+            char *args[] = {"./process", tempo_real ? "rt" : NULL, NULL};
             execv("./process", args);
             perror("Erro ao executar o processo");
             exit(1);
         } else if (pid > 0) {
             // Código do processo pai (KernelSim)
             processos[i] = pid;
+            processos_ativos[i] = 1;
+            // Todo filho fica parado até ser escalonado, para que só um processo use a CPU por vez
+            kill(pid, SIGSTOP);
         } else {
             perror("Erro ao criar processo filho");
             exit(1);
@@ -285,8 +635,13 @@ int main() {
     // Esperar um pouco para garantir que todos os processos foram criados
     sleep(1);
 
-    // Ativar o primeiro processo
-    if (processos_ativos[current_process]) {
+    // Liberar os primeiros jobs de tempo real; se houver algum, o EDF executa antes
+    liberar_jobs_rt();
+    if (heap_rt_topo() != -1) {
+        // O melhor esforço ainda está parado desde o fork: não há quem preemptar
+        melhor_esforco_preemptado = 1;
+        despachar_rt(heap_rt_topo());
+    } else if (processos_ativos[current_process]) {
         printf("KernelSim: Ativando processo %d com SIGCONT.\n", processos[current_process]);
         fflush(stdout);
         kill(processos[current_process], SIGCONT);
@@ -294,6 +649,7 @@ int main() {
         printf("KernelSim: Processo %d já terminou. Não será ativado.\n", processos[current_process]);
         fflush(stdout);
     }
+    sigprocmask(SIG_UNBLOCK, &sinais_adiados, NULL);
 
     // Loop infinito para simular o KernelSim
     while (1) {
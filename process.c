@@ -9,6 +9,7 @@
 #include <signal.h>
 #include <time.h>
 #include <errno.h>
+#include <string.h>
 
 #define MAX_ITERATIONS 10
 
@@ -75,9 +76,13 @@ void handle_sigterm(int sig) {
     exit(0);
 }
 
-int main() {
+int main(int argc, char *argv[]) {
     int kernel_pid;
 
+    // Tarefas de tempo real ("./process rt") são periódicas: não fazem I/O e só
+    // terminam quando o KernelSim manda, pois seus jobs são controlados por ele
+    int tempo_real = (argc > 1 && strcmp(argv[1], "rt") == 0);
+
     // Configurando os handlers para SIGCONT, SIGUSR1 e SIGTERM
     struct sigaction sa_cont;
     sa_cont.sa_handler = handle_sigcont;
@@ -115,7 +120,7 @@ int main() {
 
     PC = load_pc_state(); // Carregar o estado do PC
 
-    while (PC < MAX_ITERATIONS) {
+    while (tempo_real || PC < MAX_ITERATIONS) {
         // Incrementa PC antes da iteração
         PC++;
 
@@ -129,7 +134,7 @@ int main() {
         sleep(1);
 
         // Em pontos aleatórios, faz uma "syscall" de leitura/escrita
-        if (rand() % 4 == 0) { // Aproximadamente 25% das vezes
+        if (!tempo_real && rand() % 4 == 0) { // Aproximadamente 25% das vezes
             printf("Processo %d fazendo uma syscall para I/O\n", getpid());
             fflush(stdout);
             // Enviar um sinal ao KernelSim para indicar que este processo está em I/O